@@ -1,9 +1,14 @@
 #include "fw_led_matrix.h"
 
 #include <algorithm>
+#include <atomic>
+#include <bit>
 #include <format>
 #include <functional>
 #include <iostream>
+#include <new>
+#include <random>
+#include <thread>
 #include <utility>
 #include <vector>
 #include <string>
@@ -16,12 +21,14 @@
 #include <fcntl.h>
 #include <cerrno>
 #include <termios.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 static int platform_send_command(
         const std::string &device_path,
         const uint8_t data[],
         const size_t data_size,
-        const bool with_response,
+        const size_t response_length,
         std::vector<uint8_t> *response) {
     int error = 0;
     const int serial_port = open(device_path.c_str(), O_RDWR);
@@ -33,9 +40,12 @@ static int platform_send_command(
     termios tty{};
 
     if(tcgetattr(serial_port, &tty) != 0) {
-        return 1;
+        error = errno;
+        close(serial_port);
+        return error;
     }
 
+    // the matrix is a USB CDC device, the baud rate is ignored, see `fwlm::LedMatrix::calibrate_link()`
     cfsetispeed(&tty, B115200);
     cfsetospeed(&tty, B115200);
     tty.c_cc[VTIME] = 10;
@@ -45,23 +55,41 @@ static int platform_send_command(
         error = errno;
     }
 
-    if (error == 0) {
-        r = write(serial_port, data, data_size);
+    // a short write leaves a partial packet behind, so keep writing until the whole packet is sent
+    size_t written = 0;
+    while (error == 0 and written < data_size) {
+        r = write(serial_port, data + written, data_size - written);
         if (r < 0) {
-            error = errno;
+            if (errno != EINTR) {
+                error = errno;
+            }
+        } else if (r == 0) {
+            error = EIO;
+        } else {
+            written += r;
         }
     }
 
-    if (with_response and error == 0) {
+    if (response_length > 0 and error == 0) {
         response->clear();
         uint8_t read_buffer[32];
-        r = read(serial_port, read_buffer, sizeof(read_buffer));
-        if (r < 0) {
-            error = errno;
-        } else if (r == 0) {
-            error = ETIMEDOUT;
-        }else {
-            response->insert(response->end(), read_buffer, read_buffer + sizeof(read_buffer));
+        // a reply can be split over multiple USB transfers, keep reading until enough bytes arrived or VTIME expires
+        while (response->size() < std::min(response_length, sizeof(read_buffer))) {
+            r = read(serial_port, read_buffer, sizeof(read_buffer) - response->size());
+            if (r < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                error = errno;
+                break;
+            }
+            if (r == 0) {
+                if (response->empty()) {
+                    error = ETIMEDOUT;
+                }
+                break;
+            }
+            response->insert(response->end(), read_buffer, read_buffer + r);
         }
     }
 
@@ -73,23 +101,120 @@ static int platform_send_command(
 static std::string platform_error_to_string(const int error) {
     return "linux_errno:" + std::string(strerror(error));
 }
+
+static fwlm::ErrorCategory platform_error_category(const int error) {
+    switch (error) {
+        case ETIMEDOUT:
+            return fwlm::ErrorCategory::TIMEOUT;
+        case EAGAIN:
+#if EWOULDBLOCK != EAGAIN
+        case EWOULDBLOCK:
+#endif
+        case EINTR:
+        case EIO:
+        case EBUSY:
+            return fwlm::ErrorCategory::TRANSIENT;
+        default:
+            return fwlm::ErrorCategory::DEVICE;
+    }
+}
+
+static std::string platform_shared_name(const std::string &name) {
+    if (name.starts_with('/')) {
+        return name;
+    }
+    return "/" + name;
+}
+
+// when size is 0 the existing object is mapped as a whole and its size is stored in size_out
+static int platform_map_shared(
+        const std::string &name,
+        const size_t size,
+        const bool create,
+        void **mapping_out,
+        size_t *size_out,
+        void **handle_out) {
+    const std::string shm_name = platform_shared_name(name);
+    const int fd = shm_open(shm_name.c_str(), create ? O_RDWR | O_CREAT | O_EXCL : O_RDWR, 0600);
+    if (fd < 0) {
+        return errno;
+    }
+
+    size_t map_size = size;
+    if (create) {
+        if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            const int error = errno;
+            close(fd);
+            shm_unlink(shm_name.c_str());
+            return error;
+        }
+    } else {
+        struct stat st{};
+        if (fstat(fd, &st) != 0) {
+            const int error = errno;
+            close(fd);
+            return error;
+        }
+        map_size = st.st_size;
+    }
+
+    void *mapping = mmap(nullptr, map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    const int error = mapping == MAP_FAILED ? errno : 0;
+    // the mapping stays valid after the descriptor is closed
+    close(fd);
+    if (error != 0) {
+        if (create) {
+            shm_unlink(shm_name.c_str());
+        }
+        return error;
+    }
+
+    *mapping_out = mapping;
+    *size_out = map_size;
+    *handle_out = nullptr;
+    return 0;
+}
+
+static void platform_unmap_shared(
+        const std::string &name,
+        void *mapping,
+        const size_t size,
+        void *,
+        const bool remove) {
+    munmap(mapping, size);
+    if (remove) {
+        shm_unlink(platform_shared_name(name).c_str());
+    }
+}
+
+static int platform_remove_shared(const std::string &name) {
+    if (shm_unlink(platform_shared_name(name).c_str()) != 0) {
+        return errno;
+    }
+    return 0;
+}
 #elif defined(__WIN32)
 
 #include <chrono>
 
+// keep Windows.h from defining min and max macros that break std::min and std::max
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
 #include "Windows.h"
 #include "intsafe.h"
 
+// wingdi.h defines ERROR as 0, which would silently turn fwlm::ERROR into a success code below
+#undef ERROR
+
 static int platform_send_command(
         const std::string &device_path,
         const uint8_t data[],
         const size_t data_size,
-        const bool with_response,
+        const size_t response_length,
         std::vector<uint8_t> *response) {
     DWORD error = ERROR_SUCCESS;
 
-    DWORD bytesWritten = 0;
-
     HANDLE handle = ::CreateFile(device_path.c_str(),
                                           GENERIC_READ | GENERIC_WRITE, //access ( read and write)
                                           1, //(share) 0:cannot share the COM port
@@ -119,18 +244,38 @@ static int platform_send_command(
     commPortTimeouts.WriteTotalTimeoutConstant = 1000;
     SetCommTimeouts(handle, &commPortTimeouts);
 
-    WriteFile(handle, data, data_size, &bytesWritten, nullptr);
-
-    error = GetLastError();
+    // a short write leaves a partial packet behind, so keep writing until the whole packet is sent
+    size_t written = 0;
+    while (error == ERROR_SUCCESS and written < data_size) {
+        DWORD bytesWritten = 0;
+        if (not WriteFile(handle, data + written, data_size - written, &bytesWritten, nullptr)) {
+            error = GetLastError();
+        } else if (bytesWritten == 0) {
+            // the write timeout expired
+            error = ERROR_TIMEOUT;
+        } else {
+            written += bytesWritten;
+        }
+    }
 
-    if (with_response and error == ERROR_SUCCESS) {
+    if (response_length > 0 and error == ERROR_SUCCESS) {
         uint8_t buffer[32];
-        DWORD bytesRead = 0;
-        ReadFile(handle, &buffer, 32, &bytesRead, nullptr);
-
         response->clear();
-        response->insert(response->end(), buffer, buffer + sizeof(buffer));
-        error = GetLastError();
+        // a reply can be split over multiple USB transfers, keep reading until enough bytes arrived or the read times out
+        while (response->size() < std::min(response_length, sizeof(buffer))) {
+            DWORD bytesRead = 0;
+            if (not ReadFile(handle, &buffer, sizeof(buffer) - response->size(), &bytesRead, nullptr)) {
+                error = GetLastError();
+                break;
+            }
+            if (bytesRead == 0) {
+                if (response->empty()) {
+                    error = ERROR_TIMEOUT;
+                }
+                break;
+            }
+            response->insert(response->end(), buffer, buffer + bytesRead);
+        }
     }
 
     CloseHandle(handle);
@@ -161,6 +306,86 @@ static std::string platform_error_to_string(int error) {
     return "windows_getlasterror:" + std::string(message);
 }
 
+static fwlm::ErrorCategory platform_error_category(const int error) {
+    switch (error) {
+        case ERROR_TIMEOUT:
+        case ERROR_SEM_TIMEOUT:
+            return fwlm::ErrorCategory::TIMEOUT;
+        case ERROR_GEN_FAILURE:
+        case ERROR_IO_DEVICE:
+        case ERROR_OPERATION_ABORTED:
+        case ERROR_BUSY:
+        case ERROR_SHARING_VIOLATION:
+            return fwlm::ErrorCategory::TRANSIENT;
+        default:
+            return fwlm::ErrorCategory::DEVICE;
+    }
+}
+
+// when size is 0 the existing object is mapped as a whole and its size is stored in size_out
+static int platform_map_shared(
+        const std::string &name,
+        const size_t size,
+        const bool create,
+        void **mapping_out,
+        size_t *size_out,
+        void **handle_out) {
+    int error_int;
+    HANDLE handle;
+    if (create) {
+        handle = ::CreateFileMapping(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+                                     static_cast<DWORD>(static_cast<uint64_t>(size) >> 32),
+                                     static_cast<DWORD>(size & 0xFFFFFFFF),
+                                     name.c_str());
+        if (handle != nullptr and GetLastError() == ERROR_ALREADY_EXISTS) {
+            CloseHandle(handle);
+            DWordToInt(ERROR_ALREADY_EXISTS, &error_int);
+            return error_int;
+        }
+    } else {
+        handle = ::OpenFileMapping(FILE_MAP_ALL_ACCESS, FALSE, name.c_str());
+    }
+    if (handle == nullptr) {
+        DWordToInt(GetLastError(), &error_int);
+        return error_int;
+    }
+
+    void *mapping = MapViewOfFile(handle, FILE_MAP_ALL_ACCESS, 0, 0, size);
+    if (mapping == nullptr) {
+        DWordToInt(GetLastError(), &error_int);
+        CloseHandle(handle);
+        return error_int;
+    }
+
+    size_t map_size = size;
+    if (not create) {
+        MEMORY_BASIC_INFORMATION info;
+        VirtualQuery(mapping, &info, sizeof(info));
+        map_size = info.RegionSize;
+    }
+
+    *mapping_out = mapping;
+    *size_out = map_size;
+    *handle_out = handle;
+    return 0;
+}
+
+// windows removes the mapping when the last handle is closed
+static void platform_unmap_shared(
+        const std::string &,
+        void *mapping,
+        size_t,
+        void *handle,
+        bool) {
+    UnmapViewOfFile(mapping);
+    CloseHandle(handle);
+}
+
+// a mapping without open handles is already gone, even when the process that created it crashed
+static int platform_remove_shared(const std::string &) {
+    return 0;
+}
+
 #else
 #error unsupported OS. only linux and windows are supported. make sure either __linux or __WIN32 is defined
 // avoid other errors caused by above error
@@ -168,10 +393,29 @@ static int platform_send_command(
         const std::string &device_path,
         const uint8_t data[],
         size_t data_size,
-        bool with_response,
+        size_t response_length,
         std::vector<uint8_t> *response);
 
 static std::string platform_error_to_string(int error);
+
+static fwlm::ErrorCategory platform_error_category(int error);
+
+static int platform_map_shared(
+        const std::string &name,
+        size_t size,
+        bool create,
+        void **mapping_out,
+        size_t *size_out,
+        void **handle_out);
+
+static void platform_unmap_shared(
+        const std::string &name,
+        void *mapping,
+        size_t size,
+        void *handle,
+        bool remove);
+
+static int platform_remove_shared(const std::string &name);
 #endif
 
 namespace fwlm {
@@ -183,6 +427,14 @@ namespace fwlm {
                     return "fwlm:Success";
                 case -1:
                     return "fwlm:Error";
+                case -2:
+                    return "fwlm:Frame ring is full";
+                case -3:
+                    return "fwlm:Frame ring is empty";
+                case -4:
+                    return "fwlm:Shared memory object is not a valid frame ring";
+                case -5:
+                    return "fwlm:Invalid response";
                 default:
                     return "fwlm:Unknown error";
             }
@@ -190,6 +442,207 @@ namespace fwlm {
         return platform_error_to_string(error);
     }
 
+    ErrorCategory error_category(const int error) {
+        if (error == SUCCESS) {
+            return ErrorCategory::NONE;
+        }
+        if (error == INVALID_RESPONSE) {
+            return ErrorCategory::INVALID_RESPONSE;
+        }
+        if (error < 0) {
+            return ErrorCategory::LIBRARY;
+        }
+        return platform_error_category(error);
+    }
+
+    static_assert(sizeof(Frame) == 9 * 34, "fwlm::Frame must be tightly packed to be shared between processes");
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "the frame ring needs lock free 64 bit atomics");
+
+    constexpr uint32_t RING_MAGIC = 0x464C4D52; // "FLMR"
+
+    struct FrameRing::Header {
+        std::atomic<uint32_t> magic;
+        uint32_t frame_size;
+        uint32_t capacity;
+        // producer and consumer counters live on their own cache lines
+        alignas(64) std::atomic<uint64_t> write_seq;
+        alignas(64) std::atomic<uint64_t> read_seq;
+    };
+
+    FrameRing::~FrameRing() {
+        close();
+    }
+
+    FrameRing::FrameRing(FrameRing &&other) noexcept {
+        *this = std::move(other);
+    }
+
+    FrameRing &FrameRing::operator=(FrameRing &&other) noexcept {
+        if (this != &other) {
+            close();
+            _header = std::exchange(other._header, nullptr);
+            _frames = std::exchange(other._frames, nullptr);
+            _mapping = std::exchange(other._mapping, nullptr);
+            _mapping_size = std::exchange(other._mapping_size, 0);
+            _capacity = std::exchange(other._capacity, 0);
+            _writing = std::exchange(other._writing, false);
+            _reading = std::exchange(other._reading, false);
+            _handle = std::exchange(other._handle, nullptr);
+            _name = std::move(other._name);
+            _owner = std::exchange(other._owner, false);
+        }
+        return *this;
+    }
+
+    int FrameRing::create(const std::string &name, const uint32_t capacity) {
+        if (capacity == 0) {
+            throw std::invalid_argument("fw_led_matrix: FrameRing::create: the capacity of a frame ring can't be 0");
+        }
+        close();
+
+        const size_t size = sizeof(Header) + static_cast<size_t>(capacity) * sizeof(Frame);
+        const int r = platform_map_shared(name, size, true, &_mapping, &_mapping_size, &_handle);
+        if (r != 0) {
+            return r;
+        }
+
+        _header = new (_mapping) Header{};
+        _header->frame_size = sizeof(Frame);
+        _header->capacity = capacity;
+        _header->write_seq.store(0, std::memory_order_relaxed);
+        _header->read_seq.store(0, std::memory_order_relaxed);
+        _frames = reinterpret_cast<Frame *>(static_cast<uint8_t *>(_mapping) + sizeof(Header));
+        _capacity = capacity;
+        // publishing the magic last makes sure a consumer never sees a half initialised header
+        _header->magic.store(RING_MAGIC, std::memory_order_release);
+
+        _name = name;
+        _owner = true;
+        return SUCCESS;
+    }
+
+    int FrameRing::open(const std::string &name) {
+        close();
+
+        const int r = platform_map_shared(name, 0, false, &_mapping, &_mapping_size, &_handle);
+        if (r != 0) {
+            return r;
+        }
+        _name = name;
+
+        auto *header = static_cast<Header *>(_mapping);
+        if (_mapping_size < sizeof(Header)
+            or header->magic.load(std::memory_order_acquire) != RING_MAGIC
+            or header->frame_size != sizeof(Frame)) {
+            close();
+            return RING_INVALID;
+        }
+        // the header can be changed by the other process at any time, so the capacity is read and checked once
+        const uint32_t capacity = header->capacity;
+        if (capacity == 0 or _mapping_size < sizeof(Header) + static_cast<size_t>(capacity) * sizeof(Frame)) {
+            close();
+            return RING_INVALID;
+        }
+
+        _header = header;
+        _frames = reinterpret_cast<Frame *>(static_cast<uint8_t *>(_mapping) + sizeof(Header));
+        _capacity = capacity;
+        return SUCCESS;
+    }
+
+    void FrameRing::close() {
+        if (_mapping != nullptr) {
+            platform_unmap_shared(_name, _mapping, _mapping_size, _handle, _owner);
+        }
+        _header = nullptr;
+        _frames = nullptr;
+        _mapping = nullptr;
+        _mapping_size = 0;
+        _capacity = 0;
+        _writing = false;
+        _reading = false;
+        _handle = nullptr;
+        _name.clear();
+        _owner = false;
+    }
+
+    int FrameRing::remove(const std::string &name) {
+        return platform_remove_shared(name);
+    }
+
+    bool FrameRing::is_open() const {
+        return _header != nullptr;
+    }
+
+    uint32_t FrameRing::capacity() const {
+        return _capacity;
+    }
+
+    uint64_t FrameRing::size() const {
+        if (_header == nullptr) {
+            return 0;
+        }
+        const uint64_t read_seq = _header->read_seq.load(std::memory_order_acquire);
+        return _header->write_seq.load(std::memory_order_acquire) - read_seq;
+    }
+
+    Frame *FrameRing::begin_write() {
+        if (_header == nullptr) {
+            return nullptr;
+        }
+        const uint64_t write_seq = _header->write_seq.load(std::memory_order_relaxed);
+        if (write_seq - _header->read_seq.load(std::memory_order_acquire) >= _capacity) {
+            return nullptr;
+        }
+        _writing = true;
+        return &_frames[write_seq % _capacity];
+    }
+
+    void FrameRing::end_write() {
+        // without a slot from begin_write() the counter would run ahead of the consumer
+        if (_header == nullptr or not _writing) {
+            return;
+        }
+        _writing = false;
+        _header->write_seq.fetch_add(1, std::memory_order_release);
+    }
+
+    int FrameRing::push(const Frame &frame) {
+        Frame *slot = begin_write();
+        if (slot == nullptr) {
+            return RING_FULL;
+        }
+        *slot = frame;
+        end_write();
+        return SUCCESS;
+    }
+
+    const Frame *FrameRing::begin_read(const bool latest_only) {
+        if (_header == nullptr) {
+            return nullptr;
+        }
+        uint64_t read_seq = _header->read_seq.load(std::memory_order_relaxed);
+        const uint64_t write_seq = _header->write_seq.load(std::memory_order_acquire);
+        if (read_seq == write_seq) {
+            return nullptr;
+        }
+        if (latest_only and write_seq - read_seq > 1) {
+            read_seq = write_seq - 1;
+            _header->read_seq.store(read_seq, std::memory_order_release);
+        }
+        _reading = true;
+        return &_frames[read_seq % _capacity];
+    }
+
+    void FrameRing::end_read() {
+        // without a frame from begin_read() the counter would run ahead of the producer
+        if (_header == nullptr or not _reading) {
+            return;
+        }
+        _reading = false;
+        _header->read_seq.fetch_add(1, std::memory_order_release);
+    }
+
     LedMatrix::LedMatrix(std::string path): _path(std::move(path)), _matrix({{}}) {}
 
     int LedMatrix::send_command(Command cmd, const std::vector<uint8_t> &params, const bool with_response) {
@@ -201,23 +654,84 @@ namespace fwlm {
         bytes[2] = enum_to_value(cmd);
         std::ranges::copy(params, bytes + 3);
 
-        return platform_send_command(_path, bytes, n, with_response, &_response);
+        return send_packet({bytes, n}, with_response ? 1 : 0);
+    }
+
+    int LedMatrix::send_packet(const std::span<const uint8_t> packet, const size_t response_length) {
+        _command_stats.packets++;
+
+        std::chrono::milliseconds backoff = _retry_policy.initial_backoff;
+        int r = platform_send_command(_path, packet.data(), packet.size(), response_length, &_response);
+        for (unsigned int attempt = 1; r != 0 and attempt < _retry_policy.max_attempts; attempt++) {
+            const ErrorCategory category = error_category(r);
+            if (category != ErrorCategory::TRANSIENT
+                and not (category == ErrorCategory::TIMEOUT and _retry_policy.retry_timeouts)) {
+                break;
+            }
+            std::this_thread::sleep_for(backoff);
+            backoff = std::min(backoff * 2, _retry_policy.max_backoff);
+
+            _command_stats.retries++;
+            r = platform_send_command(_path, packet.data(), packet.size(), response_length, &_response);
+        }
+
+        if (r != 0) {
+            _command_stats.failures++;
+        }
+        return r;
+    }
+
+    int LedMatrix::request(const Command cmd, const size_t response_length) {
+        const std::array<uint8_t, 3> packet = {FW_MAGIC[0], FW_MAGIC[1], enum_to_value(cmd)};
+        const int r = send_packet(packet, response_length);
+        if (r != 0) {
+            return r;
+        }
+        if (_response.size() < response_length) {
+            _command_stats.invalid_responses++;
+            return INVALID_RESPONSE;
+        }
+        return SUCCESS;
     }
 
     const std::vector<uint8_t> &LedMatrix::get_last_response() const {
         return _response;
     }
 
+    void LedMatrix::set_retry_policy(const RetryPolicy &policy) {
+        _retry_policy = policy;
+    }
+
+    const RetryPolicy &LedMatrix::get_retry_policy() const {
+        return _retry_policy;
+    }
+
+    const CommandStats &LedMatrix::get_command_stats() const {
+        return _command_stats;
+    }
+
+    void LedMatrix::reset_command_stats() {
+        _command_stats = {};
+    }
+
     int LedMatrix::set_brightness(const uint8_t brightness) {
         return send_command(Command::BRIGHTNESS, {brightness}, false);
     }
 
     int LedMatrix::get_brightness(uint8_t *brightness_out) {
-        int r = send_command(Command::BRIGHTNESS, {}, true);
-        if (r == 0) {
-            *brightness_out = get_last_response()[0];
+        const Result<uint8_t> r = query_brightness();
+        if (r) {
+            *brightness_out = r.value();
         }
-        return r;
+        return r.error().code;
+    }
+
+    Result<uint8_t> LedMatrix::query_brightness() {
+        const int r = request(Command::BRIGHTNESS, 1);
+        if (r != 0) {
+            return Error(r);
+        }
+        return _response[0];
     }
 
     int LedMatrix::display_pattern(Pattern pattern) {
@@ -229,11 +743,23 @@ namespace fwlm {
     }
 
     int LedMatrix::get_sleep(bool *sleep_out) {
-        int r = send_command(Command::SLEEP, {}, true);
-        if (r == 0) {
-            *sleep_out = get_last_response()[0];
+        const Result<bool> r = query_sleep();
+        if (r) {
+            *sleep_out = r.value();
         }
-        return r;
+        return r.error().code;
+    }
+
+    Result<bool> LedMatrix::query_sleep() {
+        const int r = request(Command::SLEEP, 1);
+        if (r != 0) {
+            return Error(r);
+        }
+        if (_response[0] > 1) {
+            _command_stats.invalid_responses++;
+            return Error(INVALID_RESPONSE);
+        }
+        return _response[0] == 1;
     }
 
     int LedMatrix::set_animate(bool animate) {
@@ -241,26 +767,48 @@ namespace fwlm {
     }
 
     int LedMatrix::get_animate(bool *animate_out) {
-        int r = send_command(Command::ANIMATE, {}, true);
-        if (r == 0) {
-            *animate_out = get_last_response()[0];
+        const Result<bool> r = query_animate();
+        if (r) {
+            *animate_out = r.value();
         }
-        return r;
+        return r.error().code;
+    }
+
+    Result<bool> LedMatrix::query_animate() {
+        const int r = request(Command::ANIMATE, 1);
+        if (r != 0) {
+            return Error(r);
+        }
+        if (_response[0] > 1) {
+            _command_stats.invalid_responses++;
+            return Error(INVALID_RESPONSE);
+        }
+        return _response[0] == 1;
     }
 
     int LedMatrix::get_version(Version *version_out) {
-        int r = send_command(Command::VERSION, {}, true);
-        if (r == 0) {
-            version_out->major = get_last_response()[0];
-            version_out->minor = (get_last_response()[1] & 0b11110000) >> 4;
-            version_out->patch = get_last_response()[1] & 0b00001111;
-            version_out->is_prerelease = get_last_response()[2] & 0b00000001;
+        const Result<Version> r = query_version();
+        if (r) {
+            *version_out = r.value();
         }
-        return r;
+        return r.error().code;
+    }
+
+    Result<Version> LedMatrix::query_version() {
+        const int r = request(Command::VERSION, 3);
+        if (r != 0) {
+            return Error(r);
+        }
+        Version version{};
+        version.major = _response[0];
+        version.minor = (_response[1] & 0b11110000) >> 4;
+        version.patch = _response[1] & 0b00001111;
+        version.is_prerelease = _response[2] & 0b00000001;
+        return version;
     }
 
 
-    const std::array<std::array<uint8_t, 34>, 9> &LedMatrix::get_matrix() const {
+    const Frame &LedMatrix::get_matrix() const {
         return _matrix;
     }
 
@@ -308,29 +856,63 @@ namespace fwlm {
 
 
     int LedMatrix::draw_matrix_black_white() {
-        std::vector<uint8_t> vals = {};
+        return draw_black_white(_matrix);
+    }
 
-        for (int i = 0; i < 39; i++) {
-            vals.push_back(0);
-        }
+    int LedMatrix::draw_matrix_greyscale() {
+        return draw_greyscale(_matrix);
+    }
+
+    int LedMatrix::draw_black_white(const Frame &frame) {
+        DrawPacket packet;
+        encode_black_white(frame, &packet);
+        return send_black_white(packet);
+    }
+
+    int LedMatrix::draw_greyscale(const Frame &frame) {
+        GreyscalePackets packets;
+        encode_greyscale(frame, &packets);
+        return send_greyscale(packets);
+    }
+
+    void LedMatrix::encode_black_white(const Frame &frame, DrawPacket *packet_out) {
+        DrawPacket &packet = *packet_out;
+
+        packet.fill(0);
+        std::ranges::copy(FW_MAGIC, packet.begin());
+        packet[2] = enum_to_value(Command::DRAW);
+        uint8_t *vals = packet.data() + 3;
 
         for (int x = 0; x < 9; x++) {
             for (int y = 0; y < 34; y++) {
                 const size_t index = x + 9 * y;
-                if (_matrix[x][y]) {
+                if (frame[x][y]) {
                     vals[index / 8u] = vals[index / 8u] | (1 << (index % 8u));
                 }
             }
         }
-        return send_command(Command::DRAW, vals, false);
     }
 
-    int LedMatrix::draw_matrix_greyscale() {
-        int r;
+    void LedMatrix::encode_greyscale(const Frame &frame, GreyscalePackets *packets_out) {
         for (uint8_t x = 0; x < 9; x++) {
-            std::vector<uint8_t> vals = {x};
-            vals.insert(vals.end(), std::begin(_matrix[x]), std::end(_matrix[x]));
-            r  = send_command(Command::STAGE_COL, vals, false);
+            StageColPacket &packet = (*packets_out)[x];
+            std::ranges::copy(FW_MAGIC, packet.begin());
+            packet[2] = enum_to_value(Command::STAGE_COL);
+            packet[3] = x;
+            std::ranges::copy(frame[x], packet.begin() + 4);
+        }
+    }
+
+    int LedMatrix::send_black_white(const DrawPacket &packet) {
+        wait_for_frame_slot(_black_white_fps_limit, &_next_black_white_frame);
+        return send_packet(packet, 0);
+    }
+
+    int LedMatrix::send_greyscale(const GreyscalePackets &packets) {
+        wait_for_frame_slot(_greyscale_fps_limit, &_next_greyscale_frame);
+        int r;
+        for (const StageColPacket &packet : packets) {
+            r = send_packet(packet, 0);
             if ( r != 0 ) {
                 return r;
             }
@@ -342,6 +924,126 @@ namespace fwlm {
         return SUCCESS;
     }
 
+    void LedMatrix::wait_for_frame_slot(const double fps, std::chrono::steady_clock::time_point *next_frame) {
+        if (fps <= 0) {
+            return;
+        }
+        const auto now = std::chrono::steady_clock::now();
+        if (now < *next_frame) {
+            std::this_thread::sleep_until(*next_frame);
+        }
+        const auto interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(1.0 / fps));
+        *next_frame = std::max(now, *next_frame) + interval;
+    }
+
+    int LedMatrix::calibrate_link(const unsigned int iterations, const bool apply_limit) {
+        if (iterations == 0) {
+            throw std::invalid_argument("fw_led_matrix: calibrate_link: iterations must be at least 1");
+        }
+        using micros = std::chrono::duration<double, std::micro>;
+
+        LinkStats stats;
+        DrawPacket draw_packet;
+        GreyscalePackets stage_col_packets;
+        const std::array<uint8_t, 4> commit_packet = {FW_MAGIC[0], FW_MAGIC[1], enum_to_value(Command::COMMIT_COL), 0x00};
+        encode_black_white(_matrix, &draw_packet);
+        encode_greyscale(_matrix, &stage_col_packets);
+
+        // retrying would add the backoff to the measured latency, so a failed packet fails the calibration instead
+        struct RetryPolicyRestore {
+            LedMatrix *matrix;
+            RetryPolicy policy;
+            ~RetryPolicyRestore() {
+                matrix->_retry_policy = policy;
+            }
+        } restore{this, _retry_policy};
+        _retry_policy.max_attempts = 1;
+
+        // packets are sent directly so the frame rate limit doesn't influence the measurement
+        const auto send_timed = [this](const std::span<const uint8_t> packet, double *total_us, double *max_us) {
+            const auto start = std::chrono::steady_clock::now();
+            const int r = send_packet(packet, 0);
+            const double us = micros(std::chrono::steady_clock::now() - start).count();
+            *total_us += us;
+            *max_us = std::max(*max_us, us);
+            return r;
+        };
+
+        double draw_total_us = 0;
+        double stage_col_total_us = 0;
+        double commit_total_us = 0;
+        size_t bytes = 0;
+        int r;
+        for (unsigned int i = 0; i < iterations; i++) {
+            r = send_timed(draw_packet, &draw_total_us, &stats.draw_latency_max_us);
+            if (r != 0) {
+                return r;
+            }
+            bytes += draw_packet.size();
+        }
+        for (unsigned int i = 0; i < iterations; i++) {
+            for (const StageColPacket &packet : stage_col_packets) {
+                r = send_timed(packet, &stage_col_total_us, &stats.stage_col_latency_max_us);
+                if (r != 0) {
+                    return r;
+                }
+                bytes += packet.size();
+            }
+            r = send_timed(commit_packet, &commit_total_us, &stats.commit_col_latency_max_us);
+            if (r != 0) {
+                return r;
+            }
+            bytes += commit_packet.size();
+        }
+
+        const double total_us = draw_total_us + stage_col_total_us + commit_total_us;
+        stats.calibrated = true;
+        stats.bytes_per_second = total_us > 0 ? static_cast<double>(bytes) / (total_us / 1e6) : 0;
+        stats.draw_latency_us = draw_total_us / iterations;
+        stats.stage_col_latency_us = stage_col_total_us / (iterations * stage_col_packets.size());
+        stats.commit_col_latency_us = commit_total_us / iterations;
+
+        const double black_white_frame_us = stats.draw_latency_us;
+        const double greyscale_frame_us = stats.stage_col_latency_us * stage_col_packets.size() + stats.commit_col_latency_us;
+        stats.max_black_white_fps = black_white_frame_us > 0 ? 1e6 / black_white_frame_us : 0;
+        stats.max_greyscale_fps = greyscale_frame_us > 0 ? 1e6 / greyscale_frame_us : 0;
+
+        _link_stats = stats;
+        if (apply_limit) {
+            // leave some headroom so a slow packet doesn't immediately make frames pile up
+            set_frame_rate_limit(stats.max_black_white_fps * 0.9, stats.max_greyscale_fps * 0.9);
+        }
+        return SUCCESS;
+    }
+
+    const LinkStats &LedMatrix::get_link_stats() const {
+        return _link_stats;
+    }
+
+    void LedMatrix::set_frame_rate_limit(const double black_white_fps, const double greyscale_fps) {
+        _black_white_fps_limit = std::max(black_white_fps, 0.0);
+        _greyscale_fps_limit = std::max(greyscale_fps, 0.0);
+    }
+
+    double LedMatrix::get_frame_rate_limit(const bool greyscale) const {
+        return greyscale ? _greyscale_fps_limit : _black_white_fps_limit;
+    }
+
+    int LedMatrix::present_from_ring(FrameRing &ring, const bool greyscale, const bool latest_only) {
+        const Frame *frame = ring.begin_read(latest_only);
+        if (frame == nullptr) {
+            return RING_EMPTY;
+        }
+        const int r = greyscale ? draw_greyscale(*frame) : draw_black_white(*frame);
+        // a frame that failed stays in the ring so the next call draws it again,
+        // with latest_only that call skips it anyway when a newer frame has arrived
+        if (r == SUCCESS) {
+            ring.end_read();
+        }
+        return r;
+    }
+
     void LedMatrix::clear() {
         for (int x = 0; x < 9; x++) {
             for (int y = 0; y < 34; y++) {
@@ -375,4 +1077,370 @@ namespace fwlm {
         return send_command(Command::GAME_CONTROL, {enum_to_value(game_control_value)}, false);
     }
 
+    VideoWall::VideoWall(std::vector<WallTile> tiles): _tiles(std::move(tiles)), _errors(_tiles.size(), SUCCESS) {
+        for (size_t i = 0; i < _tiles.size(); i++) {
+            if (_tiles[i].matrix == nullptr) {
+                throw std::invalid_argument(std::format("fw_led_matrix: VideoWall: tile {} has no matrix", i));
+            }
+            for (size_t j = 0; j < i; j++) {
+                // the tiles are drawn concurrently, a shared matrix would be used by two threads at once
+                if (_tiles[j].matrix == _tiles[i].matrix) {
+                    throw std::invalid_argument(std::format("fw_led_matrix: VideoWall: tile {} and tile {} use the "
+                                                            "same matrix, every tile needs its own matrix", j, i));
+                }
+            }
+        }
+
+        // writing to a module blocks, so every module gets its own worker even when there are more modules than cores
+        _workers.reserve(_tiles.size());
+        try {
+            for (size_t i = 0; i < _tiles.size(); i++) {
+                _workers.emplace_back(&VideoWall::run_worker, this, i);
+            }
+        } catch (...) {
+            stop_workers();
+            throw;
+        }
+    }
+
+    VideoWall::~VideoWall() {
+        stop_workers();
+    }
+
+    void VideoWall::stop_workers() {
+        {
+            std::lock_guard lock(_mutex);
+            _stopping = true;
+        }
+        _work_ready.notify_all();
+        for (std::thread &worker : _workers) {
+            worker.join();
+        }
+        _workers.clear();
+    }
+
+    void VideoWall::run_worker(const size_t tile_index) {
+        uint64_t drawn_frame = 0;
+        for (;;) {
+            {
+                std::unique_lock lock(_mutex);
+                _work_ready.wait(lock, [this, drawn_frame] { return _stopping or _frame != drawn_frame; });
+                if (_stopping) {
+                    return;
+                }
+                drawn_frame = _frame;
+            }
+
+            const WallTile &tile = _tiles[tile_index];
+            int r;
+            try {
+                Frame frame;
+                cut_tile(*_canvas, tile, &frame);
+                if (_greyscale) {
+                    GreyscalePackets packets;
+                    LedMatrix::encode_greyscale(frame, &packets);
+                    r = tile.matrix->send_greyscale(packets);
+                } else {
+                    DrawPacket packet;
+                    LedMatrix::encode_black_white(frame, &packet);
+                    r = tile.matrix->send_black_white(packet);
+                }
+            } catch (...) {
+                // an exception can't leave the worker, draw() would wait for this tile forever
+                r = ERROR;
+            }
+
+            {
+                std::lock_guard lock(_mutex);
+                _errors[tile_index] = r;
+                if (--_pending == 0) {
+                    _work_done.notify_one();
+                }
+            }
+        }
+    }
+
+    int VideoWall::draw(const std::vector<std::vector<uint8_t>> &canvas, const bool greyscale) {
+        {
+            std::lock_guard lock(_mutex);
+            _canvas = &canvas;
+            _greyscale = greyscale;
+            _pending = _workers.size();
+            _frame++;
+        }
+        _work_ready.notify_all();
+
+        {
+            std::unique_lock lock(_mutex);
+            _work_done.wait(lock, [this] { return _pending == 0; });
+            _canvas = nullptr;
+        }
+
+        for (const int error : _errors) {
+            if (error != SUCCESS) {
+                return error;
+            }
+        }
+        return SUCCESS;
+    }
+
+    const std::vector<int> &VideoWall::get_last_errors() const {
+        return _errors;
+    }
+
+    const std::vector<WallTile> &VideoWall::get_tiles() const {
+        return _tiles;
+    }
+
+    void VideoWall::cut_tile(const std::vector<std::vector<uint8_t>> &canvas, const WallTile &tile, Frame *frame_out) {
+        for (unsigned int x = 0; x < 9; x++) {
+            for (unsigned int y = 0; y < 34; y++) {
+                // position of the pixel on the canvas, relative to the top-left corner of the tile
+                unsigned int cx, cy;
+                switch (tile.rotation) {
+                    case Rotation::ROTATE_90:
+                        cx = 33 - y;
+                        cy = x;
+                        break;
+                    case Rotation::ROTATE_180:
+                        cx = 8 - x;
+                        cy = 33 - y;
+                        break;
+                    case Rotation::ROTATE_270:
+                        cx = y;
+                        cy = 8 - x;
+                        break;
+                    default:
+                        cx = x;
+                        cy = y;
+                        break;
+                }
+                cx += tile.x;
+                cy += tile.y;
+
+                uint8_t value = 0;
+                if (cx < canvas.size() and cy < canvas[cx].size()) {
+                    value = canvas[cx][cy];
+                }
+                (*frame_out)[x][y] = value;
+            }
+        }
+    }
+
+    constexpr uint64_t LIFE_COLUMN_MASK = (uint64_t{1} << 34) - 1;
+
+    GameOfLife::GameOfLife(const std::string &rule, const bool wrap): _wrap(wrap) {
+        set_rule(rule);
+    }
+
+    void GameOfLife::set_rule(const std::string &rule) {
+        const auto invalid = [&rule] {
+            return std::invalid_argument(std::format("fw_led_matrix: GameOfLife: rule \"{}\" is not in B/S notation "
+                                                     "(like \"B3/S23\" or \"S23/B3\")", rule));
+        };
+
+        uint16_t birth_mask = 0;
+        uint16_t survive_mask = 0;
+        bool seen_birth = false;
+        bool seen_survive = false;
+        size_t i = 0;
+
+        // the rule is exactly two parts, B<digits> and S<digits> in any order, with at most one '/' between them
+        for (int part = 0; part < 2; part++) {
+            if (part == 1 and i < rule.size() and rule[i] == '/') {
+                i++;
+            }
+            if (i >= rule.size()) {
+                throw invalid();
+            }
+
+            uint16_t *mask;
+            const char letter = rule[i++];
+            if ((letter == 'B' or letter == 'b') and not seen_birth) {
+                seen_birth = true;
+                mask = &birth_mask;
+            } else if ((letter == 'S' or letter == 's') and not seen_survive) {
+                seen_survive = true;
+                mask = &survive_mask;
+            } else {
+                throw invalid();
+            }
+
+            while (i < rule.size() and rule[i] >= '0' and rule[i] <= '8') {
+                *mask |= 1 << (rule[i] - '0');
+                i++;
+            }
+        }
+        if (i != rule.size()) {
+            throw invalid();
+        }
+        set_rule(birth_mask, survive_mask);
+    }
+
+    void GameOfLife::set_rule(const uint16_t birth_mask, const uint16_t survive_mask) {
+        _birth_mask = birth_mask & 0x1FF;
+        _survive_mask = survive_mask & 0x1FF;
+    }
+
+    void GameOfLife::set_wrap(const bool wrap) {
+        _wrap = wrap;
+    }
+
+    bool GameOfLife::get_wrap() const {
+        return _wrap;
+    }
+
+    void GameOfLife::load(const Frame &frame) {
+        for (int x = 0; x < 9; x++) {
+            uint64_t column = 0;
+            for (int y = 0; y < 34; y++) {
+                if (frame[x][y]) {
+                    column |= uint64_t{1} << y;
+                }
+            }
+            _columns[x] = column;
+        }
+        _generation = 0;
+    }
+
+    void GameOfLife::store(Frame *frame_out, const uint8_t alive_value) const {
+        for (int x = 0; x < 9; x++) {
+            for (int y = 0; y < 34; y++) {
+                (*frame_out)[x][y] = (_columns[x] >> y) & 1 ? alive_value : 0;
+            }
+        }
+    }
+
+    void GameOfLife::randomize(const uint64_t seed, const double density) {
+        std::mt19937_64 rng(seed);
+        std::bernoulli_distribution alive(std::clamp(density, 0.0, 1.0));
+        for (uint64_t &column : _columns) {
+            column = 0;
+            for (int y = 0; y < 34; y++) {
+                if (alive(rng)) {
+                    column |= uint64_t{1} << y;
+                }
+            }
+        }
+        _generation = 0;
+    }
+
+    void GameOfLife::set_cell(const bool alive, const unsigned int x, const unsigned int y) {
+        if (x > 8 or y > 33) {
+            throw std::out_of_range(std::format("fw_led_matrix: GameOfLife: set_cell: ({}, {}) is out of bounds", x, y));
+        }
+        if (alive) {
+            _columns[x] |= uint64_t{1} << y;
+        } else {
+            _columns[x] &= ~(uint64_t{1} << y);
+        }
+    }
+
+    bool GameOfLife::get_cell(const unsigned int x, const unsigned int y) const {
+        if (x > 8 or y > 33) {
+            throw std::out_of_range(std::format("fw_led_matrix: GameOfLife: get_cell: ({}, {}) is out of bounds", x, y));
+        }
+        return (_columns[x] >> y) & 1;
+    }
+
+    void GameOfLife::clear() {
+        _columns.fill(0);
+        _generation = 0;
+    }
+
+    void GameOfLife::step(const unsigned int generations) {
+        const bool wrap = _wrap;
+        // the neighbour above and below of every cell in a column
+        const auto above = [wrap](const uint64_t column) {
+            const uint64_t shifted = column << 1;
+            return (wrap ? shifted | (column >> 33) : shifted) & LIFE_COLUMN_MASK;
+        };
+        const auto below = [wrap](const uint64_t column) {
+            const uint64_t shifted = column >> 1;
+            return wrap ? shifted | ((column & 1) << 33) : shifted;
+        };
+
+        for (unsigned int generation = 0; generation < generations; generation++) {
+            std::array<uint64_t, 9> next{};
+            for (int x = 0; x < 9; x++) {
+                const uint64_t center = _columns[x];
+                const uint64_t left = x > 0 ? _columns[x - 1] : (wrap ? _columns[8] : 0);
+                const uint64_t right = x < 8 ? _columns[x + 1] : (wrap ? _columns[0] : 0);
+
+                const uint64_t neighbours[8] = {
+                    left, above(left), below(left),
+                    right, above(right), below(right),
+                    above(center), below(center),
+                };
+
+                // count the neighbours of all cells in the column at once,
+                // bit y of count[i] is bit i of the neighbour count of the cell at (x, y)
+                uint64_t count[4] = {0, 0, 0, 0};
+                for (const uint64_t neighbour : neighbours) {
+                    const uint64_t carry0 = count[0] & neighbour;
+                    count[0] ^= neighbour;
+                    const uint64_t carry1 = count[1] & carry0;
+                    count[1] ^= carry0;
+                    const uint64_t carry2 = count[2] & carry1;
+                    count[2] ^= carry1;
+                    count[3] |= carry2;
+                }
+
+                uint64_t alive = 0;
+                for (int n = 0; n <= 8; n++) {
+                    const bool birth = (_birth_mask >> n) & 1;
+                    const bool survive = (_survive_mask >> n) & 1;
+                    if (not birth and not survive) {
+                        continue;
+                    }
+                    uint64_t equal = LIFE_COLUMN_MASK;
+                    for (int bit = 0; bit < 4; bit++) {
+                        equal &= (n >> bit) & 1 ? count[bit] : ~count[bit];
+                    }
+                    alive |= equal & ((birth ? ~center : 0) | (survive ? center : 0));
+                }
+                next[x] = alive & LIFE_COLUMN_MASK;
+            }
+            _columns = next;
+        }
+        _generation += generations;
+    }
+
+    unsigned int GameOfLife::population() const {
+        unsigned int population = 0;
+        for (const uint64_t column : _columns) {
+            population += std::popcount(column);
+        }
+        return population;
+    }
+
+    uint64_t GameOfLife::generation() const {
+        return _generation;
+    }
+
+    void GameOfLife::encode(DrawPacket *packet_out) const {
+        DrawPacket &packet = *packet_out;
+
+        packet.fill(0);
+        std::ranges::copy(FW_MAGIC, packet.begin());
+        packet[2] = LedMatrix::enum_to_value(Command::DRAW);
+        uint8_t *vals = packet.data() + 3;
+
+        for (int x = 0; x < 9; x++) {
+            uint64_t column = _columns[x];
+            while (column != 0) {
+                const int y = std::countr_zero(column);
+                column &= column - 1;
+                const size_t index = x + 9 * y;
+                vals[index / 8u] = vals[index / 8u] | (1 << (index % 8u));
+            }
+        }
+    }
+
+    int GameOfLife::draw(LedMatrix &matrix) const {
+        DrawPacket packet;
+        encode(&packet);
+        return matrix.send_black_white(packet);
+    }
+
 }
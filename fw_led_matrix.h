@@ -1,8 +1,16 @@
 #ifndef FW_LED_MATRIX_H
 #define FW_LED_MATRIX_H
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 #include <string>
+#include <cstddef>
 #include <cstdint>
+#include <optional>
 #include <span>
+#include <stdexcept>
+#include <thread>
 #include <vector>
 
 namespace fwlm {
@@ -11,6 +19,10 @@ namespace fwlm {
     enum error {
         SUCCESS = 0,
         ERROR = -1,
+        RING_FULL = -2,
+        RING_EMPTY = -3,
+        RING_INVALID = -4,
+        INVALID_RESPONSE = -5,
     };
 
     // according to https://github.com/FrameworkComputer/inputmodule-rs/blob/main/commands.md
@@ -93,6 +105,281 @@ namespace fwlm {
          */
         std::string error_to_string(int error);
 
+    /**
+     * what kind of failure an error code describes
+     */
+    enum class ErrorCategory: uint8_t {
+        // the code is `fwlm::SUCCESS`
+        NONE = 0,
+        // the error came from this library
+        LIBRARY = 1,
+        // the matrix didn't respond in time
+        TIMEOUT = 2,
+        // the operation may succeed when it's tried again (EAGAIN, EIO, ...)
+        TRANSIENT = 3,
+        // the device can't be used (missing, no permission, ...), trying again won't help
+        DEVICE = 4,
+        // the matrix responded with a reply that is too short or doesn't make sense
+        INVALID_RESPONSE = 5,
+    };
+
+    /**
+     * get the category of an error code returned by this library
+     * @param error the code to categorize
+     * @return the category
+     */
+    ErrorCategory error_category(int error);
+
+    /**
+     * an error code together with its category
+     */
+    struct Error {
+        int code = SUCCESS;
+        ErrorCategory category = ErrorCategory::NONE;
+
+        Error() = default;
+        explicit Error(const int code): code(code), category(error_category(code)) {}
+
+        [[nodiscard]] std::string to_string() const {
+            return error_to_string(code);
+        }
+    };
+
+    /**
+     * either a value or an `fwlm::Error`, like `std::expected`
+     */
+    template <typename T>
+    class Result {
+    public:
+        Result(T value): _value(std::move(value)) {}
+        Result(const Error error): _error(error) {}
+
+        [[nodiscard]] bool has_value() const {
+            return _value.has_value();
+        }
+
+        explicit operator bool() const {
+            return has_value();
+        }
+
+        /**
+         * @return the value
+         * @exception runtime_error when there is no value, the message is the error message
+         */
+        [[nodiscard]] const T &value() const {
+            if (not _value.has_value()) {
+                throw std::runtime_error("fw_led_matrix: Result::value: no value, error: " + _error.to_string());
+            }
+            return *_value;
+        }
+
+        [[nodiscard]] T value_or(T default_value) const {
+            return _value.has_value() ? *_value : std::move(default_value);
+        }
+
+        /**
+         * @return the error, its code is `fwlm::SUCCESS` when there is a value
+         */
+        [[nodiscard]] const Error &error() const {
+            return _error;
+        }
+
+    private:
+        std::optional<T> _value;
+        Error _error;
+    };
+
+    /**
+     * how often a packet is retried when sending it fails with a `TRANSIENT` or `TIMEOUT` error
+     * the wait between attempts starts at `initial_backoff` and is multiplied by 2 after every attempt
+     */
+    struct RetryPolicy {
+        // the total amount of attempts, 1 means packets are never retried
+        unsigned int max_attempts = 3;
+        std::chrono::milliseconds initial_backoff{2};
+        std::chrono::milliseconds max_backoff{50};
+        bool retry_timeouts = true;
+    };
+
+    /**
+     * counters of how many packets were sent to a matrix and how many of them failed
+     */
+    struct CommandStats {
+        uint64_t packets = 0;
+        // packets that still failed after all retries
+        uint64_t failures = 0;
+        uint64_t retries = 0;
+        uint64_t invalid_responses = 0;
+
+        [[nodiscard]] double failure_rate() const {
+            return packets == 0 ? 0.0 : static_cast<double>(failures) / static_cast<double>(packets);
+        }
+    };
+
+    /**
+     * a full frame for the matrix, in column major order, the same layout as the internal matrix of `fwlm::LedMatrix`
+     */
+    using Frame = std::array<std::array<uint8_t, 34>, 9>;
+
+    /**
+     * a complete `DRAW` packet: magic, command and 39 bytes with 1 bit per pixel
+     */
+    using DrawPacket = std::array<uint8_t, 3 + 39>;
+
+    /**
+     * a complete `STAGE_COL` packet: magic, command, column index and 34 brightness values
+     */
+    using StageColPacket = std::array<uint8_t, 3 + 1 + 34>;
+
+    /**
+     * all `STAGE_COL` packets needed to draw a greyscale frame, one per column
+     */
+    using GreyscalePackets = std::array<StageColPacket, 9>;
+
+    /**
+     * the results of `fwlm::LedMatrix::calibrate_link()`
+     *
+     * the matrix is a USB CDC device so the configured baud rate has no effect on how fast it is,
+     * these numbers are measured instead.
+     */
+    struct LinkStats {
+        bool calibrated = false;
+        // sustained throughput of DRAW and STAGE_COL traffic
+        double bytes_per_second = 0;
+        double draw_latency_us = 0;
+        double draw_latency_max_us = 0;
+        double stage_col_latency_us = 0;
+        double stage_col_latency_max_us = 0;
+        double commit_col_latency_us = 0;
+        double commit_col_latency_max_us = 0;
+        // the highest frame rates the link can sustain
+        double max_black_white_fps = 0;
+        double max_greyscale_fps = 0;
+    };
+
+    /**
+     * a single producer, single consumer ring of frames living in shared memory
+     *
+     * one process creates the ring and renders frames into it, another process opens the ring by name and presents
+     * the frames with `fwlm::LedMatrix::present_from_ring()`.
+     * The frames are read straight from shared memory while the packets are assembled, so they are never copied
+     * into the internal matrix.
+     *
+     * On linux the ring is backed by `shm_open`, on windows by a named file mapping.
+     * Only one producer and one consumer may use a ring at the same time.
+     */
+    class FrameRing {
+    public:
+        FrameRing() = default;
+        ~FrameRing();
+
+        FrameRing(const FrameRing &) = delete;
+        FrameRing &operator=(const FrameRing &) = delete;
+        FrameRing(FrameRing &&other) noexcept;
+        FrameRing &operator=(FrameRing &&other) noexcept;
+
+        /**
+         * create a new ring, the ring is removed again when the creating `FrameRing` is closed
+         * fails when a ring with the same name already exists, see `remove()`
+         * @param name the name of the shared memory object, on linux a leading '/' is added when missing
+         * @param capacity how many frames the ring can hold
+         * @return An error code.
+         * Returns 0 on success.
+         * Returns errno on failure on linux.
+         * Returns the result of GetLastError() on failure on windows.
+         * @exception invalid_argument when capacity is 0
+         */
+        int create(const std::string &name, uint32_t capacity);
+
+        /**
+         * open a ring created by another `FrameRing`
+         * @param name the name the ring was created with
+         * @return An error code.
+         * Returns 0 on success.
+         * Returns `fwlm::RING_INVALID` when the shared memory object is not a ring created by this library.
+         * Returns errno on failure on linux.
+         * Returns the result of GetLastError() on failure on windows.
+         */
+        int open(const std::string &name);
+
+        /**
+         * unmap the ring, does nothing when the ring isn't open
+         */
+        void close();
+
+        /**
+         * remove a ring that was left behind, for example because the process that created it crashed
+         * `create()` fails with EEXIST on linux as long as the old ring exists.
+         * Processes that still have the old ring open can keep using it.
+         * On windows a ring is removed when the last process using it exits, so this does nothing.
+         * @param name the name the ring was created with
+         * @return An error code.
+         * Returns 0 on success.
+         * Returns errno on failure on linux, ENOENT if there is no ring with this name.
+         */
+        static int remove(const std::string &name);
+
+        [[nodiscard]] bool is_open() const;
+
+        /**
+         * @return how many frames the ring can hold, 0 if the ring isn't open
+         */
+        [[nodiscard]] uint32_t capacity() const;
+
+        /**
+         * @return how many frames are waiting to be read
+         */
+        [[nodiscard]] uint64_t size() const;
+
+        /**
+         * producer: get the next free slot to render into
+         * @return the slot, or nullptr if the ring is full or not open
+         */
+        Frame *begin_write();
+
+        /**
+         * producer: publish the slot returned by the last `begin_write()`
+         * does nothing when `begin_write()` didn't return a slot
+         */
+        void end_write();
+
+        /**
+         * producer: copy a frame into the ring and publish it
+         * @param frame the frame to publish
+         * @return `fwlm::SUCCESS` on success, `fwlm::RING_FULL` if there is no free slot
+         */
+        int push(const Frame &frame);
+
+        /**
+         * consumer: get the oldest published frame, the frame stays valid until `end_read()` is called
+         * @param latest_only if true, all frames except the newest one are dropped
+         * @return the frame, or nullptr if the ring is empty or not open
+         */
+        const Frame *begin_read(bool latest_only = false);
+
+        /**
+         * consumer: release the frame returned by the last `begin_read()` so the producer can reuse its slot
+         * does nothing when `begin_read()` didn't return a frame
+         */
+        void end_read();
+
+    private:
+        struct Header;
+
+        Header *_header = nullptr;
+        Frame *_frames = nullptr;
+        void *_mapping = nullptr;
+        size_t _mapping_size = 0;
+        // validated copy of the capacity in the header, the header itself is writable by the other process
+        uint32_t _capacity = 0;
+        // set while a slot from begin_write() / begin_read() hasn't been released yet
+        bool _writing = false;
+        bool _reading = false;
+        void *_handle = nullptr;
+        std::string _name;
+        bool _owner = false;
+    };
+
     class LedMatrix {
     public:
         explicit LedMatrix(std::string path);
@@ -110,10 +397,11 @@ namespace fwlm {
 
         /**
          * sends a command to the matrix
-         * may block for up to 1.0s
+         * every attempt may block for up to 1.0s, failed attempts are retried according to the retry policy,
+         * so with the default `fwlm::RetryPolicy` this may block for about 3.0s plus the backoff between attempts
          * @param cmd the Command to send
          * @param params a list of params to send, how many params are needed depends on the command
-         * @param with_response if true, this will wait for a response for up to 1.0s,
+         * @param with_response if true, every attempt will wait for a response for up to 1.0s,
          *      if no bytes where read the function wil return the timed out error code
          * @return An error code.
          * Returns 0 on success.
@@ -128,6 +416,25 @@ namespace fwlm {
          */
         [[nodiscard]] const std::vector<uint8_t> &get_last_response() const;
 
+        /**
+         * set how failed packets are retried, applies to every packet sent to the matrix
+         * @param policy the new policy
+         */
+        void set_retry_policy(const RetryPolicy &policy);
+
+        [[nodiscard]] const RetryPolicy &get_retry_policy() const;
+
+        /**
+         * get how many packets were sent to the matrix and how many failed
+         * @return the counters
+         */
+        [[nodiscard]] const CommandStats &get_command_stats() const;
+
+        /**
+         * set all counters of `get_command_stats()` to 0
+         */
+        void reset_command_stats();
+
         /**
          * sets the brightness of the LED matrix
          * @param brightness the new brightness
@@ -143,11 +450,18 @@ namespace fwlm {
          * @param brightness_out where to store the brightness
          * @return An error code.
          * Returns 0 on success.
+         * Returns `fwlm::INVALID_RESPONSE` when the reply is too short or doesn't make sense.
          * Returns errno on failure on linux.
          * Returns the result of GetLastError() on failure on windows.
          */
         int get_brightness(uint8_t *brightness_out);
 
+        /**
+         * gets the brightness of the matrix
+         * @return the brightness or the error, `INVALID_RESPONSE` when the reply is too short
+         */
+        Result<uint8_t> query_brightness();
+
         /**
          * display e pre-programmed pattern on the matrix
          * @param pattern the pattern to display
@@ -173,11 +487,18 @@ namespace fwlm {
          * @param sleep_out where to store the sleep state
          * @return An error code.
          * Returns 0 on success.
+         * Returns `fwlm::INVALID_RESPONSE` when the reply is too short or doesn't make sense.
          * Returns errno on failure on linux.
          * Returns the result of GetLastError() on failure on windows.
          */
         int get_sleep(bool *sleep_out);
 
+        /**
+         * gets if the matrix is asleep
+         * @return the sleep state or the error, `INVALID_RESPONSE` when the reply is too short or not a boolean
+         */
+        Result<bool> query_sleep();
+
         /**
          * sets if the current pattern should scroll
          * @param animate the new animation state
@@ -193,26 +514,40 @@ namespace fwlm {
          * @param animate_out where to store if the current pattern is scrolling
          * @return An error code.
          * Returns 0 on success.
+         * Returns `fwlm::INVALID_RESPONSE` when the reply is too short or doesn't make sense.
          * Returns errno on failure on linux.
          * Returns the result of GetLastError() on failure on windows.
          */
         int get_animate(bool *animate_out);
 
+        /**
+         * gets if the current pattern is scrolling
+         * @return the animation state or the error, `INVALID_RESPONSE` when the reply is too short or not a boolean
+         */
+        Result<bool> query_animate();
+
         /**
          * gets the version info of the matrix
          * @param version_out where to store the version info
          * @return An error code.
          * Returns 0 on success.
+         * Returns `fwlm::INVALID_RESPONSE` when the reply is too short or doesn't make sense.
          * Returns errno on failure on linux.
          * Returns the result of GetLastError() on failure on windows.
          */
         int get_version(Version *version_out);
 
+        /**
+         * gets the version info of the matrix
+         * @return the version or the error, `INVALID_RESPONSE` when the reply is too short
+         */
+        Result<Version> query_version();
+
         /**
          * get the internal matrix
          * @return the matrix
          */
-        [[nodiscard]] const std::array<std::array<uint8_t, 34>, 9> &get_matrix() const;
+        [[nodiscard]] const Frame &get_matrix() const;
 
         /**
          * blit some data to the internal matrix
@@ -260,6 +595,116 @@ namespace fwlm {
          */
         int draw_matrix_greyscale();
 
+        /**
+         * draw a frame using 1 bit color, the internal matrix is not changed
+         * @param frame the frame to draw
+         * @return An error code.
+         * Returns 0 on success.
+         * Returns errno on failure on linux.
+         * Returns the result of GetLastError() on failure on windows.
+         */
+        int draw_black_white(const Frame &frame);
+
+        /**
+         * encode a frame into a `DRAW` packet without sending it
+         * @param frame the frame to encode, pixels are interpreted as booleans (0 = OFF, 1 to 255 = ON)
+         * @param packet_out where to store the packet
+         */
+        static void encode_black_white(const Frame &frame, DrawPacket *packet_out);
+
+        /**
+         * encode a frame into `STAGE_COL` packets without sending them
+         * @param frame the frame to encode
+         * @param packets_out where to store the packets
+         */
+        static void encode_greyscale(const Frame &frame, GreyscalePackets *packets_out);
+
+        /**
+         * send a `DRAW` packet created by `encode_black_white()`
+         * @param packet the packet to send
+         * @return An error code.
+         * Returns 0 on success.
+         * Returns errno on failure on linux.
+         * Returns the result of GetLastError() on failure on windows.
+         */
+        int send_black_white(const DrawPacket &packet);
+
+        /**
+         * send the `STAGE_COL` packets created by `encode_greyscale()` followed by a `COMMIT_COL`
+         * @param packets the packets to send
+         * @return An error code.
+         * Returns 0 on success.
+         * Returns errno on failure on linux.
+         * Returns the result of GetLastError() on failure on windows.
+         */
+        int send_greyscale(const GreyscalePackets &packets);
+
+        /**
+         * draw a frame using greyscale color, the internal matrix is not changed
+         * @param frame the frame to draw
+         * @return An error code.
+         * Returns 0 on success.
+         * Returns errno on failure on linux.
+         * Returns the result of GetLastError() on failure on windows.
+         */
+        int draw_greyscale(const Frame &frame);
+
+        /**
+         * measure how fast the link to the matrix is by sending DRAW and STAGE_COL traffic
+         * may block for a few seconds, the internal matrix is drawn in 1 bit color and in greyscale while measuring
+         *
+         * the results are stored with this matrix and can be read using `get_link_stats()`.
+         * Packets are not retried while measuring, if any packet fails the calibration fails and the old results are kept.
+         * @param iterations how many frames to send in each color mode
+         * @param apply_limit if true, the frame rate limit is set to 90% of the measured maximum frame rates
+         * @return An error code.
+         * Returns 0 on success.
+         * Returns errno on failure on linux.
+         * Returns the result of GetLastError() on failure on windows.
+         * @exception invalid_argument when iterations is 0
+         */
+        int calibrate_link(unsigned int iterations = 20, bool apply_limit = true);
+
+        /**
+         * get the results of the last successful `calibrate_link()`
+         * @return the link stats, `calibrated` is false when the link hasn't been calibrated yet
+         */
+        [[nodiscard]] const LinkStats &get_link_stats() const;
+
+        /**
+         * limit how many frames per second are sent to the matrix
+         * drawing a frame blocks until the next frame is allowed to be sent
+         * @param black_white_fps the limit for frames drawn in 1 bit color, 0 means no limit
+         * @param greyscale_fps the limit for frames drawn in greyscale, 0 means no limit
+         */
+        void set_frame_rate_limit(double black_white_fps, double greyscale_fps);
+
+        /**
+         * get the frame rate limit
+         * @param greyscale if true, get the limit for greyscale frames, otherwise for 1 bit color frames
+         * @return the limit in frames per second, 0 means no limit
+         */
+        [[nodiscard]] double get_frame_rate_limit(bool greyscale) const;
+
+        /**
+         * draw the oldest frame waiting in a shared memory ring and release it
+         * the packets are assembled straight from shared memory, the internal matrix is not changed
+         *
+         * the frame is only released when it was drawn successfully, a frame that failed is drawn again by the next call
+         * (unless `latest_only` is true and a newer frame is waiting).
+         * The slot of the frame stays held while waiting for the frame rate limit, so the producer has one slot less
+         * during that time.
+         * @param ring the ring to read from
+         * @param greyscale if true the frame is drawn with `draw_greyscale()`, otherwise with `draw_black_white()`
+         * @param latest_only if true, all frames except the newest one are dropped
+         * @return An error code.
+         * Returns 0 on success.
+         * Returns `fwlm::RING_EMPTY` if there was no frame to draw.
+         * Returns errno on failure on linux.
+         * Returns the result of GetLastError() on failure on windows.
+         */
+        int present_from_ring(FrameRing &ring, bool greyscale = true, bool latest_only = false);
+
         /**
          * sets all values in the internal matrix to 0
          */
@@ -318,9 +763,230 @@ namespace fwlm {
         int game_control(GameControl game_control_value);
 
     private:
+        // response_length is how many bytes of the reply are needed, 0 when the packet has no reply
+        int send_packet(std::span<const uint8_t> packet, size_t response_length);
+        int request(Command cmd, size_t response_length);
+        void wait_for_frame_slot(double fps, std::chrono::steady_clock::time_point *next_frame);
+
         std::string _path;
         std::vector<uint8_t> _response;
-        std::array<std::array<uint8_t, 34>, 9> _matrix;
+        Frame _matrix;
+        LinkStats _link_stats;
+        double _black_white_fps_limit = 0;
+        double _greyscale_fps_limit = 0;
+        // every color mode is paced on its own, so switching modes doesn't skip the interval of the other mode
+        std::chrono::steady_clock::time_point _next_black_white_frame;
+        std::chrono::steady_clock::time_point _next_greyscale_frame;
+        RetryPolicy _retry_policy;
+        CommandStats _command_stats;
+    };
+
+    /**
+     * how a module of a `fwlm::VideoWall` is mounted, rotations are clockwise
+     */
+    enum class Rotation: uint8_t {
+        NONE = 0,
+        ROTATE_90 = 1,
+        ROTATE_180 = 2,
+        ROTATE_270 = 3,
+    };
+
+    /**
+     * one module of a `fwlm::VideoWall`
+     *
+     * x and y are the position of the top-left corner of the area the module covers on the canvas.
+     * A module covers 9x34 pixels of the canvas, or 34x9 pixels when it's rotated by 90 or 270 degrees.
+     */
+    struct WallTile {
+        LedMatrix *matrix;
+        unsigned int x;
+        unsigned int y;
+        Rotation rotation = Rotation::NONE;
+    };
+
+    /**
+     * draws one large canvas over many modules
+     *
+     * every module has its own worker thread that cuts its tile from the canvas, encodes it and sends it,
+     * so encoding scales with the amount of cores and the modules are written to concurrently.
+     * The workers are started by the constructor and stopped by the destructor.
+     * `draw()` may only be called from one thread at a time.
+     */
+    class VideoWall {
+    public:
+        /**
+         * @param tiles the layout of the wall
+         * @exception invalid_argument when a tile has no matrix or when two tiles share the same matrix
+         * @exception system_error when the worker threads can't be started
+         */
+        explicit VideoWall(std::vector<WallTile> tiles);
+        ~VideoWall();
+
+        VideoWall(const VideoWall &) = delete;
+        VideoWall &operator=(const VideoWall &) = delete;
+
+        /**
+         * draw a canvas to all modules of the wall
+         *
+         * pixels of a tile that fall outside the canvas are drawn as 0
+         *
+         * @param canvas the canvas to draw, in column major order just like `fwlm::LedMatrix::blit()`
+         * @param greyscale if true the tiles are drawn in greyscale, otherwise in 1 bit color
+         * @return An error code.
+         * Returns 0 when all modules were drawn successfully.
+         * Returns the error of the first failing tile otherwise, see `get_last_errors()` for the error of every tile.
+         */
+        int draw(const std::vector<std::vector<uint8_t>> &canvas, bool greyscale = true);
+
+        /**
+         * get the error code of every tile from the last call to `draw()`, in the same order as the tiles
+         * @return the error codes
+         */
+        [[nodiscard]] const std::vector<int> &get_last_errors() const;
+
+        [[nodiscard]] const std::vector<WallTile> &get_tiles() const;
+
+        /**
+         * cut the area covered by a tile from a canvas, undoing the rotation of the tile
+         * @param canvas the canvas, in column major order
+         * @param tile the tile to cut
+         * @param frame_out where to store the frame
+         */
+        static void cut_tile(const std::vector<std::vector<uint8_t>> &canvas, const WallTile &tile, Frame *frame_out);
+
+    private:
+        void run_worker(size_t tile_index);
+        void stop_workers();
+
+        std::vector<WallTile> _tiles;
+        std::vector<int> _errors;
+
+        std::vector<std::thread> _workers;
+        std::mutex _mutex;
+        std::condition_variable _work_ready;
+        std::condition_variable _work_done;
+        // the canvas of the frame that is being drawn, only valid while draw() runs
+        const std::vector<std::vector<uint8_t>> *_canvas = nullptr;
+        bool _greyscale = true;
+        uint64_t _frame = 0;
+        size_t _pending = 0;
+        bool _stopping = false;
+    };
+
+    /**
+     * a game of life that runs on the host and is streamed to the matrix using 1 bit color
+     *
+     * unlike `fwlm::GameID::GAME_OF_LIFE` the rules, speed and seed can be chosen freely
+     * and the matrix keeps responding to other commands.
+     * Every column of the board is stored as a bitboard, so a generation is computed with a few bitwise operations
+     * per column.
+     */
+    class GameOfLife {
+    public:
+        /**
+         * @param rule the rule in B/S notation, for example "B3/S23" for Conway's game of life
+         * @param wrap if true, cells on an edge are neighbours of the cells on the opposite edge
+         * @exception invalid_argument when the rule can't be parsed
+         */
+        explicit GameOfLife(const std::string &rule = "B3/S23", bool wrap = true);
+
+        /**
+         * set the rule
+         * @param rule the rule in B/S notation, for example "B36/S23" for HighLife.
+         * Accepted are `B<digits>/S<digits>` and `S<digits>/B<digits>` with digits from 0 to 8,
+         * the letters may be lowercase and the '/' may be left out.
+         * @exception invalid_argument when the rule can't be parsed
+         */
+        void set_rule(const std::string &rule);
+
+        /**
+         * set the rule using bit masks, bit n is set when a cell with n neighbours is born or survives
+         * @param birth_mask which neighbour counts make a dead cell come alive
+         * @param survive_mask which neighbour counts keep a living cell alive
+         */
+        void set_rule(uint16_t birth_mask, uint16_t survive_mask);
+
+        void set_wrap(bool wrap);
+
+        [[nodiscard]] bool get_wrap() const;
+
+        /**
+         * use a frame as the board, every pixel that isn't 0 is alive
+         * use `load(led_matrix.get_matrix())` to start from the internal matrix
+         * @param frame the frame to load
+         */
+        void load(const Frame &frame);
+
+        /**
+         * store the board in a frame
+         * @param frame_out where to store the board
+         * @param alive_value the value of living cells, dead cells are 0
+         */
+        void store(Frame *frame_out, uint8_t alive_value = 255) const;
+
+        /**
+         * fill the board with random cells
+         * @param seed the seed for the random number generator, the same seed always gives the same board
+         * @param density the chance for a cell to be alive, from 0.0 to 1.0
+         */
+        void randomize(uint64_t seed, double density = 0.5);
+
+        /**
+         * set a cell, using the same coordinates as the matrix
+         * @exception out_of_range when the cell is out of bounds
+         */
+        void set_cell(bool alive, unsigned int x, unsigned int y);
+
+        /**
+         * get a cell, using the same coordinates as the matrix
+         * @exception out_of_range when the cell is out of bounds
+         */
+        [[nodiscard]] bool get_cell(unsigned int x, unsigned int y) const;
+
+        /**
+         * kill all cells
+         */
+        void clear();
+
+        /**
+         * advance the board
+         * @param generations how many generations to advance
+         */
+        void step(unsigned int generations = 1);
+
+        /**
+         * @return how many cells are alive
+         */
+        [[nodiscard]] unsigned int population() const;
+
+        /**
+         * @return how many generations have been computed since the board was last loaded, randomized or cleared
+         */
+        [[nodiscard]] uint64_t generation() const;
+
+        /**
+         * encode the board into a `DRAW` packet without sending it
+         * @param packet_out where to store the packet
+         */
+        void encode(DrawPacket *packet_out) const;
+
+        /**
+         * draw the board on a matrix using 1 bit color, the internal matrix of the matrix is not changed
+         * @param matrix the matrix to draw on
+         * @return An error code.
+         * Returns 0 on success.
+         * Returns errno on failure on linux.
+         * Returns the result of GetLastError() on failure on windows.
+         */
+        int draw(LedMatrix &matrix) const;
+
+    private:
+        // bit y of a column is the cell at (x, y)
+        std::array<uint64_t, 9> _columns{};
+        uint16_t _birth_mask = 0;
+        uint16_t _survive_mask = 0;
+        bool _wrap;
+        uint64_t _generation = 0;
     };
 }
 
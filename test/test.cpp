@@ -2,9 +2,468 @@
 // Created by pim on 10/24/25.
 //
 #include <cstring>
+#include <random>
 
 #include "../fw_led_matrix.h"
 
+#if defined(__linux)
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <fcntl.h>
+#include <map>
+#include <mutex>
+#include <poll.h>
+#include <termios.h>
+#include <thread>
+#include <unistd.h>
+
+// a pseudo terminal that accepts packets like a matrix, so the library can be checked without a matrix
+class FakeMatrix {
+public:
+    FakeMatrix() {
+        _master = posix_openpt(O_RDWR | O_NOCTTY);
+        grantpt(_master);
+        unlockpt(_master);
+        _path = ptsname(_master);
+
+        // keep the other side open in raw mode, otherwise the line discipline changes the packets
+        _slave = open(_path.c_str(), O_RDWR | O_NOCTTY);
+        termios tty{};
+        tcgetattr(_slave, &tty);
+        cfmakeraw(&tty);
+        tcsetattr(_slave, TCSANOW, &tty);
+
+        _thread = std::thread([this] { run(); });
+    }
+
+    ~FakeMatrix() {
+        _stopping = true;
+        _thread.join();
+        close(_slave);
+        close(_master);
+    }
+
+    [[nodiscard]] const std::string &path() const {
+        return _path;
+    }
+
+    // answer a command with these bytes, commands without a reply aren't answered
+    void set_reply(const fwlm::Command cmd, std::vector<uint8_t> reply) {
+        std::lock_guard lock(_mutex);
+        _replies[fwlm::LedMatrix::enum_to_value(cmd)] = std::move(reply);
+    }
+
+    // don't answer the next `count` commands that have a reply
+    void drop_replies(const int count) {
+        std::lock_guard lock(_mutex);
+        _drop = count;
+    }
+
+    // send every reply in two parts with a pause in between, like a reply split over two USB transfers
+    void set_split_replies(const bool split) {
+        std::lock_guard lock(_mutex);
+        _split = split;
+    }
+
+private:
+    void run() {
+        uint8_t buffer[256];
+        while (not _stopping) {
+            pollfd fd{_master, POLLIN, 0};
+            if (poll(&fd, 1, 10) <= 0) {
+                continue;
+            }
+            const ssize_t n = read(_master, buffer, sizeof(buffer));
+            if (n < 3 or buffer[0] != fwlm::FW_MAGIC[0] or buffer[1] != fwlm::FW_MAGIC[1]) {
+                continue;
+            }
+
+            std::vector<uint8_t> reply;
+            bool split;
+            {
+                std::lock_guard lock(_mutex);
+                const auto it = _replies.find(buffer[2]);
+                if (it == _replies.end()) {
+                    continue;
+                }
+                if (_drop > 0) {
+                    _drop--;
+                    continue;
+                }
+                reply = it->second;
+                split = _split;
+            }
+
+            if (split and reply.size() > 1) {
+                write(_master, reply.data(), 1);
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                write(_master, reply.data() + 1, reply.size() - 1);
+            } else {
+                write(_master, reply.data(), reply.size());
+            }
+        }
+    }
+
+    int _master;
+    int _slave;
+    std::string _path;
+    std::atomic<bool> _stopping = false;
+    std::thread _thread;
+    std::mutex _mutex;
+    std::map<uint8_t, std::vector<uint8_t>> _replies;
+    int _drop = 0;
+    bool _split = false;
+};
+
+// link calibration and frame pacing, every color mode is paced on its own
+static int check_link() {
+    int failures = 0;
+    FakeMatrix fake;
+    fwlm::LedMatrix matrix(fake.path());
+
+    const int r = matrix.calibrate_link(5);
+    const fwlm::LinkStats &stats = matrix.get_link_stats();
+    if (r != fwlm::SUCCESS or not stats.calibrated or stats.max_black_white_fps <= 0 or stats.max_greyscale_fps <= 0
+        or stats.commit_col_latency_max_us < stats.commit_col_latency_us) {
+        printf("FAIL: LedMatrix::calibrate_link, error %d\n", r);
+        failures++;
+    } else if (matrix.get_frame_rate_limit(true) != stats.max_greyscale_fps * 0.9) {
+        printf("FAIL: LedMatrix::calibrate_link should set the frame rate limit\n");
+        failures++;
+    }
+
+    // a greyscale frame every 100ms must not hold back black and white frames
+    matrix.set_frame_rate_limit(1000, 10);
+    const auto start = std::chrono::steady_clock::now();
+    matrix.draw_matrix_greyscale();
+    const auto black_white_start = std::chrono::steady_clock::now();
+    matrix.draw_matrix_black_white();
+    const auto black_white_end = std::chrono::steady_clock::now();
+    matrix.draw_matrix_greyscale();
+    const auto end = std::chrono::steady_clock::now();
+
+    if (black_white_end - black_white_start > std::chrono::milliseconds(50)) {
+        printf("FAIL: a black and white frame waited for the greyscale frame rate limit\n");
+        failures++;
+    }
+    if (end - start < std::chrono::milliseconds(95)) {
+        printf("FAIL: greyscale frames were sent faster than the frame rate limit\n");
+        failures++;
+    }
+    return failures;
+}
+
+// replies are checked before they are used, split replies are put back together and dropped replies are retried
+static int check_replies() {
+    int failures = 0;
+    FakeMatrix fake;
+    fwlm::LedMatrix matrix(fake.path());
+
+    std::vector<uint8_t> brightness_reply(32, 0);
+    brightness_reply[0] = 0x42;
+    fake.set_reply(fwlm::Command::BRIGHTNESS, brightness_reply);
+    const fwlm::Result<uint8_t> brightness = matrix.query_brightness();
+    if (not brightness or brightness.value() != 0x42) {
+        printf("FAIL: LedMatrix::query_brightness, error %d\n", brightness.error().code);
+        failures++;
+    }
+
+    fake.set_reply(fwlm::Command::VERSION, {0x00, 0x91});
+    if (matrix.query_version().error().code != fwlm::INVALID_RESPONSE) {
+        printf("FAIL: LedMatrix::query_version should reject a reply that is too short\n");
+        failures++;
+    }
+
+    std::vector<uint8_t> sleep_reply(32, 0);
+    sleep_reply[0] = 7;
+    fake.set_reply(fwlm::Command::SLEEP, sleep_reply);
+    if (matrix.query_sleep().error().code != fwlm::INVALID_RESPONSE) {
+        printf("FAIL: LedMatrix::query_sleep should reject a reply that isn't a boolean\n");
+        failures++;
+    }
+    if (matrix.get_command_stats().invalid_responses != 2) {
+        printf("FAIL: CommandStats::invalid_responses is %llu instead of 2\n",
+               static_cast<unsigned long long>(matrix.get_command_stats().invalid_responses));
+        failures++;
+    }
+
+    std::vector<uint8_t> version_reply(32, 0);
+    version_reply[0] = 0x00;
+    version_reply[1] = 0x91;
+    version_reply[2] = 0x01;
+    fake.set_reply(fwlm::Command::VERSION, version_reply);
+    fake.set_split_replies(true);
+    const fwlm::Result<fwlm::Version> version = matrix.query_version();
+    if (not version or version.value().to_string() != "0.9.1_prerelease") {
+        printf("FAIL: LedMatrix::query_version should put a split reply back together, error %d\n",
+               version.error().code);
+        failures++;
+    }
+    fake.set_split_replies(false);
+
+    // the first attempt times out after 1.0s, the retry gets the reply
+    matrix.reset_command_stats();
+    fake.drop_replies(1);
+    const fwlm::Result<uint8_t> retried = matrix.query_brightness();
+    const fwlm::CommandStats &stats = matrix.get_command_stats();
+    if (not retried or stats.retries != 1 or stats.failures != 0) {
+        printf("FAIL: LedMatrix should retry a command that timed out, error %d, %llu retries\n",
+               retried.error().code, static_cast<unsigned long long>(stats.retries));
+        failures++;
+    }
+    return failures;
+}
+#endif
+
+// error categories, results and failure counters
+static int check_errors() {
+    int failures = 0;
+
+    struct ExpectedCategory {
+        int error;
+        fwlm::ErrorCategory category;
+    };
+    const ExpectedCategory expected_categories[] = {
+        {fwlm::SUCCESS, fwlm::ErrorCategory::NONE},
+        {fwlm::ERROR, fwlm::ErrorCategory::LIBRARY},
+        {fwlm::RING_FULL, fwlm::ErrorCategory::LIBRARY},
+        {fwlm::INVALID_RESPONSE, fwlm::ErrorCategory::INVALID_RESPONSE},
+#if defined(__linux)
+        {EIO, fwlm::ErrorCategory::TRANSIENT},
+        {EAGAIN, fwlm::ErrorCategory::TRANSIENT},
+        {ETIMEDOUT, fwlm::ErrorCategory::TIMEOUT},
+        {ENOENT, fwlm::ErrorCategory::DEVICE},
+#endif
+    };
+    for (const ExpectedCategory &expected : expected_categories) {
+        if (fwlm::error_category(expected.error) != expected.category) {
+            printf("FAIL: error_category(%d)\n", expected.error);
+            failures++;
+        }
+    }
+
+    const fwlm::Result<int> value(5);
+    if (not value or value.value() != 5 or value.value_or(7) != 5 or value.error().code != fwlm::SUCCESS) {
+        printf("FAIL: Result with a value\n");
+        failures++;
+    }
+    const fwlm::Result<int> error(fwlm::Error(fwlm::INVALID_RESPONSE));
+    if (error or error.value_or(7) != 7 or error.error().category != fwlm::ErrorCategory::INVALID_RESPONSE) {
+        printf("FAIL: Result with an error\n");
+        failures++;
+    }
+    try {
+        (void) error.value();
+        printf("FAIL: Result::value should throw when there is no value\n");
+        failures++;
+    } catch (const std::runtime_error &) {
+    }
+
+    // a missing device can't be fixed by trying again
+    fwlm::LedMatrix missing("/nonexistent/fwlm_test_matrix");
+    const int r = missing.set_brightness(0x10);
+    const fwlm::CommandStats &stats = missing.get_command_stats();
+    if (r == fwlm::SUCCESS or stats.packets != 1 or stats.failures != 1 or stats.retries != 0
+        or stats.failure_rate() != 1.0) {
+        printf("FAIL: CommandStats for a missing device\n");
+        failures++;
+    }
+    return failures;
+}
+
+// counts the neighbours of every cell one by one, to check the bitboards of fwlm::GameOfLife against
+static fwlm::Frame reference_life_step(const fwlm::Frame &frame, const bool wrap, const uint16_t birth_mask,
+                                       const uint16_t survive_mask) {
+    fwlm::Frame next{};
+    for (int x = 0; x < 9; x++) {
+        for (int y = 0; y < 34; y++) {
+            int neighbours = 0;
+            for (int dx = -1; dx <= 1; dx++) {
+                for (int dy = -1; dy <= 1; dy++) {
+                    if (dx == 0 and dy == 0) {
+                        continue;
+                    }
+                    int nx = x + dx;
+                    int ny = y + dy;
+                    if (wrap) {
+                        nx = (nx + 9) % 9;
+                        ny = (ny + 34) % 34;
+                    } else if (nx < 0 or nx > 8 or ny < 0 or ny > 33) {
+                        continue;
+                    }
+                    neighbours += frame[nx][ny] != 0;
+                }
+            }
+            const uint16_t mask = frame[x][y] ? survive_mask : birth_mask;
+            next[x][y] = (mask >> neighbours) & 1 ? 255 : 0;
+        }
+    }
+    return next;
+}
+
+// frame ring: frames come out in order and unmatched end_read()/end_write() don't corrupt the ring
+static int check_frame_ring() {
+    int failures = 0;
+
+    fwlm::FrameRing::remove("fwlm_test_ring");
+    fwlm::FrameRing producer;
+    fwlm::FrameRing consumer;
+    if (producer.create("fwlm_test_ring", 2) != fwlm::SUCCESS or consumer.open("fwlm_test_ring") != fwlm::SUCCESS) {
+        printf("FAIL: FrameRing::create/open\n");
+        failures++;
+    } else {
+        consumer.end_read();
+        producer.end_write();
+        fwlm::Frame frame{};
+        for (uint8_t i = 0; i < 3; i++) {
+            frame[0][0] = i;
+            const int expected = i < 2 ? fwlm::SUCCESS : fwlm::RING_FULL;
+            if (producer.push(frame) != expected) {
+                printf("FAIL: FrameRing::push %d\n", i);
+                failures++;
+            }
+        }
+        for (uint8_t i = 0; i < 2; i++) {
+            const fwlm::Frame *read = consumer.begin_read();
+            if (read == nullptr or (*read)[0][0] != i) {
+                printf("FAIL: FrameRing::begin_read %d\n", i);
+                failures++;
+            }
+            consumer.end_read();
+        }
+        if (consumer.begin_read() != nullptr or consumer.size() != 0) {
+            printf("FAIL: FrameRing should be empty\n");
+            failures++;
+        }
+
+        // a frame that can't be drawn stays in the ring
+        fwlm::LedMatrix missing("/nonexistent/fwlm_test_matrix");
+        producer.push(frame);
+        if (missing.present_from_ring(consumer, false) == fwlm::SUCCESS or consumer.size() != 1) {
+            printf("FAIL: LedMatrix::present_from_ring should keep a frame that failed\n");
+            failures++;
+        }
+    }
+    return failures;
+}
+
+// video wall: a rotated tile must show the canvas turned back, and a tile that fails is reported
+static int check_video_wall() {
+    int failures = 0;
+
+    std::vector<std::vector<uint8_t>> canvas(34, std::vector<uint8_t>(9));
+    for (size_t x = 0; x < canvas.size(); x++) {
+        for (size_t y = 0; y < canvas[x].size(); y++) {
+            canvas[x][y] = x * 9 + y;
+        }
+    }
+    const fwlm::Rotation rotations[] = {fwlm::Rotation::ROTATE_90, fwlm::Rotation::ROTATE_270};
+    for (const fwlm::Rotation rotation : rotations) {
+        fwlm::Frame frame;
+        fwlm::VideoWall::cut_tile(canvas, {nullptr, 0, 0, rotation}, &frame);
+        for (int x = 0; x < 9; x++) {
+            for (int y = 0; y < 34; y++) {
+                const int cx = rotation == fwlm::Rotation::ROTATE_90 ? 33 - y : y;
+                const int cy = rotation == fwlm::Rotation::ROTATE_90 ? x : 8 - x;
+                if (frame[x][y] != canvas[cx][cy]) {
+                    printf("FAIL: VideoWall::cut_tile, rotation %d at (%d, %d)\n",
+                           fwlm::LedMatrix::enum_to_value(rotation), x, y);
+                    failures++;
+                    x = 9;
+                    break;
+                }
+            }
+        }
+    }
+
+    fwlm::LedMatrix missing("/nonexistent/fwlm_test_matrix");
+    fwlm::VideoWall wall({{&missing, 0, 0}});
+    if (wall.draw(canvas, false) == fwlm::SUCCESS or wall.get_last_errors()[0] == fwlm::SUCCESS) {
+        printf("FAIL: VideoWall::draw should report the failing tile\n");
+        failures++;
+    }
+    return failures;
+}
+
+// game of life: random rules, both wrap modes, compared to the reference and to LedMatrix's DRAW encoding
+static int check_game_of_life() {
+    int failures = 0;
+    std::mt19937 rng(1234);
+
+    for (int i = 0; i < 200; i++) {
+        const uint16_t birth_mask = rng() & 0x1FF;
+        const uint16_t survive_mask = rng() & 0x1FF;
+        const bool wrap = i % 2;
+
+        fwlm::GameOfLife life("B3/S23", wrap);
+        life.set_rule(birth_mask, survive_mask);
+        life.randomize(i, 0.4);
+
+        fwlm::Frame expected;
+        life.store(&expected);
+        for (int generation = 0; generation < 10; generation++) {
+            expected = reference_life_step(expected, wrap, birth_mask, survive_mask);
+            life.step();
+
+            fwlm::Frame actual;
+            life.store(&actual);
+            if (actual != expected) {
+                printf("FAIL: GameOfLife::step, board %d generation %d\n", i, generation);
+                failures++;
+                break;
+            }
+        }
+
+        fwlm::DrawPacket actual_packet;
+        fwlm::DrawPacket expected_packet;
+        life.encode(&actual_packet);
+        fwlm::LedMatrix::encode_black_white(expected, &expected_packet);
+        if (actual_packet != expected_packet) {
+            printf("FAIL: GameOfLife::encode, board %d\n", i);
+            failures++;
+        }
+    }
+
+    const char *valid_rules[] = {"B3/S23", "S23/B3", "b36s23", "B/S"};
+    for (const char *rule : valid_rules) {
+        try {
+            fwlm::GameOfLife life(rule);
+        } catch (const std::invalid_argument &) {
+            printf("FAIL: GameOfLife should accept rule \"%s\"\n", rule);
+            failures++;
+        }
+    }
+    const char *invalid_rules[] = {"", "B3", "B//3S23", "B3/S23/", "/B3S23", "B3/B3", "B9/S23", "B3/ S23"};
+    for (const char *rule : invalid_rules) {
+        try {
+            fwlm::GameOfLife life(rule);
+            printf("FAIL: GameOfLife should reject rule \"%s\"\n", rule);
+            failures++;
+        } catch (const std::invalid_argument &) {
+        }
+    }
+    return failures;
+}
+
+// checks that don't need a matrix, returns the amount of failed checks
+static int run_checks() {
+    int failures = 0;
+
+    failures += check_game_of_life();
+    failures += check_video_wall();
+    failures += check_frame_ring();
+    failures += check_errors();
+#if defined(__linux)
+    failures += check_link();
+    failures += check_replies();
+#endif
+
+    printf("%d checks failed\n", failures);
+    return failures;
+}
+
 std::vector<std::vector<uint8_t>> image = {
     {
         {
@@ -21,6 +480,10 @@ std::vector<std::vector<uint8_t>> image = {
 };
 
 int main() {
+    if (run_checks() != 0) {
+        return 1;
+    }
+
     int r;
     fwlm::LedMatrix led_matrix("/dev/ttyACM0");
 